@@ -13,7 +13,10 @@
 #ifndef __COM_BASE_H__
 #define __COM_BASE_H__
 
+#include <atomic>
+#include <mutex>
 #include <set>
+#include "Tracer.hpp"
 #include "com_devel.hpp"
 #include "maps.hpp"
 
@@ -88,6 +91,12 @@ class COM_base {
   /// Deletes a pane and its associated data.
   void delete_pane(const std::string &wname, const int pid);
 
+  /// Selects a distributed pane directory for a window if distributed is
+  /// nonzero, or a replicated one otherwise (the default). It takes effect
+  /// at the next call to window_init_done with pane changes.
+  /// @see ComponentInterface::set_pane_directory
+  void set_pane_directory(const std::string &wname, int distributed);
+
   //\}
 
   /** \name DataItem management
@@ -265,6 +274,16 @@ class COM_base {
         const_cast<COM_base *>(this)->get_window_handle(wname));
   }
 
+  /// Obtains a pointer to an dataitem from its handle.
+  DataItem *get_dataitem_object(int hdl) { return &get_dataitem(hdl); }
+  const DataItem *get_dataitem_object(int hdl) const {
+    return &get_dataitem(hdl);
+  }
+
+  /// Obtains a pointer to an dataitem that will be written, with the
+  /// checks that call_function applies to output arguments.
+  DataItem *get_output_dataitem_object(int hdl);
+
   int get_dataitem_handle(const std::string &waname);
   int get_dataitem_handle_const(const std::string &waname);
   int get_function_handle(const std::string &wfname);
@@ -297,7 +316,8 @@ class COM_base {
   /// Get the number of arguments of a given function from its handle
   int get_num_arguments(const int wf);
 
-  /** Invoke a function with given arguments.
+  /** Invoke a function with given arguments. Functions may be invoked
+   *  from several threads at once; the call depth is kept per thread.
    *  \param wf the handle to the function.
    *  \param count the number of input arguments.
    *  \param args the addresses to the arguments.
@@ -344,6 +364,16 @@ class COM_base {
   void set_profiling(int i);
   void set_profiling_barrier(int hdl, MPI_Comm comm);
   void print_profile(const std::string &fname, const std::string &header);
+
+  /// Turns on (or off) tracing of function calls if i!=0 (or ==0),
+  /// keeping at most capacity events per thread. Turning it on discards
+  /// previous events.
+  void set_tracing(int i, int capacity = 0);
+  /// Writes the traced events of all processes of the default communicator
+  /// into a Chrome trace file. It is collective.
+  void print_trace(const std::string &fname);
+  /// Obtains the tracer, e.g., to trace regions of code with Trace_region.
+  Tracer &tracer() { return _tracer; }
   //\}
 
   /** \name Miscellaneous
@@ -419,15 +449,19 @@ class COM_base {
   Function_map _func_map;
 
   std::string _libdir;         ///< Library directory.
-  std::vector<double> _timer;  ///< Timers for function calls
-  int _depth;                  ///< Depth of procedure calls
+  static thread_local std::vector<double> _timer;  ///< Timers for function
+                                                   ///< calls of the thread
+  static thread_local int _depth;  ///< Depth of procedure calls of the thread
   int _verbose;                ///< Indicates whether verbose is on
   int _verb1;             ///< Indicates whether to print detailed information
   MPI_Comm _comm;         ///< Default communicator of COM
   bool _mpi_initialized;  ///< Indicates whether MPI was initialized by COM
-  int _errorcode;         ///< Error code
+  std::atomic<int> _errorcode;  ///< Error code
   bool _exception_on;     ///< Indicates whether COM should throw exception
   bool _profile_on;       ///< Indicates whether should profile
+  std::mutex _profile_mutex;  ///< Guards the profile in _func_map
+  Tracer _tracer;         ///< Records timelines of function calls
+  std::string _trace_file;  ///< File to write the trace into at finalize
 
   int _f90_mangling;    ///< Encoding name mangling.
                         ///< -1: Unknown.
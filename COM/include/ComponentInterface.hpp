@@ -9,6 +9,8 @@
 #define __COM_COMPONENT_INTERFACE_H__
 
 #include <map>
+#include <utility>
+#include <vector>
 #include "Function.hpp"
 #include "Pane.hpp"
 
@@ -37,7 +39,11 @@ class ComponentInterface {
   typedef Pane::OP_Init OP_Init;
 
  public:
-  typedef std::map<int, int> Proc_map;
+  /// Pane IDs and the ranks of their owner processes, sorted by pane ID.
+  typedef std::vector<std::pair<int, int> > Proc_map;
+
+  /// Ways of keeping track of the owners of panes (see set_pane_directory).
+  enum Pane_directory { PANE_DIRECTORY_REPLICATED, PANE_DIRECTORY_DISTRIBUTED };
 
   // Used by get_array. Note that the default dimension is -1, which
   // is for void*. Nonnegative dimensions are reserved for Fortran pointers.
@@ -234,6 +240,10 @@ class ComponentInterface {
   /// Perform some final checking of the CI.
   void init_done(bool pane_changed = true);
 
+  /// Obtain a stamp that changes every time init_done is called. It can
+  /// be used to validate data derived from the panes of the CI.
+  long init_stamp() const { return _init_stamp; }
+
   //\}
 
   /** \name Pane management
@@ -243,16 +253,51 @@ class ComponentInterface {
   int size_of_panes() const { return _pane_map.size(); }
 
   /// Obtain the total number of panes in the CI window on all processes.
-  int size_of_panes_global() const { return _proc_map.size(); }
+  int size_of_panes_global() const { return _npanes_global; }
 
   /// Obtain the process rank that owns a given pane. Returns -1 if
-  /// the pane cannot be found in the process map.
+  /// the pane is not in the CI window. With a distributed pane directory,
+  /// the pane must be local or have been passed to resolve_panes.
   int owner_rank(const int pane_id) const;
 
+  /// Obtain an index of a pane that is unique and contiguous across all
+  /// processes, e.g. for defining MPI tags. Returns -1 if the pane is not
+  /// in the CI window. The same restriction as for owner_rank applies.
+  int pane_index(const int pane_id) const;
+
+  /** Select how the owners of panes are tracked. It takes effect at the
+   *  next call to init_done with pane changes.
+   *
+   *  With PANE_DIRECTORY_REPLICATED (the default), init_done gathers the
+   *  IDs of all panes on every process. With PANE_DIRECTORY_DISTRIBUTED,
+   *  each process holds the owners of the panes whose IDs hash to it, and
+   *  only knows the owners of its own panes and of the panes it looked up
+   *  with resolve_panes, so that the memory and communication per process
+   *  do not grow with the total number of panes.
+   */
+  void set_pane_directory(Pane_directory d) { _directory_mode = d; }
+
+  /// Obtain how the owners of panes are requested to be tracked.
+  Pane_directory pane_directory() const { return _directory_mode; }
+
+  /// Whether the pane directory in use is distributed. It is replicated
+  /// without MPI, even if PANE_DIRECTORY_DISTRIBUTED was requested.
+  bool is_distributed() const { return _distributed; }
+
+  /** Look up the owners of the given panes in a distributed pane directory
+   *  and keep them in the process map, e.g. the neighbors of the local
+   *  panes. This is collective over the communicator of the CI, but each
+   *  process may pass different panes. Does nothing if every process
+   *  already knows all panes.
+   */
+  void resolve_panes(const std::vector<int> &pane_ids);
+
   /// Return the last dataitem id.
   int last_dataitem_id() const { return _last_id; }
 
-  /// Obtain the process map
+  /// Obtain the process map. With a distributed pane directory, it contains
+  /// only the local panes and those passed to resolve_panes, including
+  /// panes not in the window with a rank of -1.
   const Proc_map &proc_map() const { return _proc_map; }
 
   /// Remove the pane with given ID.
@@ -276,7 +321,10 @@ class ComponentInterface {
   Pane &pane(const int pane_id, bool insert = false);
   const Pane &pane(const int pane_id) const;
 
-  /// Obtain all the local panes of the CI window.
+  /// Obtain the IDs of the local panes of the CI window (rank == -2), of
+  /// the panes on all processes (rank == -1), or of the panes on the given
+  /// process. With a distributed pane directory, only the panes of the
+  /// calling process can be obtained.
   void panes(std::vector<int> &ps, int rank = -2);
 
   /// Obtain all the local panes of the CI window.
@@ -343,18 +391,32 @@ class ComponentInterface {
   Func_map _func_map;  ///< Map from function names to their metadata.
   Pane_map _pane_map;  ///< Map from pane ID to their metadata.
   Proc_map _proc_map;  ///< Map from pane ID to process ranks
+  std::vector<int> _pane_indices;  ///< Global indices of the panes in
+                                   ///< _proc_map if _distributed
+  int _npanes_global;  ///< Number of panes on all processes.
+
+  Pane_directory _directory_mode;  ///< Requested pane directory.
+  bool _distributed;               ///< Whether the pane directory in use
+                                   ///< is distributed.
+  Proc_map _directory;  ///< The part of a distributed pane directory
+                        ///< held by this process.
+  int _directory_offset;  ///< Global index of the first pane in _directory.
 
   int _last_id;    ///< The last used dataitem index. The next
                    ///< available one is _last_id+1.
   MPI_Comm _comm;  ///< the MPI communicator of the CI.
   enum { STATUS_SHRUNK, STATUS_CHANGED, STATUS_NOCHANGE };
   int _status;  ///< Status of the CI.
+  long _init_stamp;  ///< Stamp of the last call to init_done.
 
  private:
   // Disable the following two functions (they are dangerous)
   ComponentInterface(const ComponentInterface &);
   ComponentInterface &operator=(const ComponentInterface &);
 
+  /// Distribute the given local panes into a hashed pane directory.
+  void build_pane_directory(const std::vector<int> &pane_ids, int nprocs);
+
  private:
 #ifdef DOXYGEN
   // This is to fool DOXYGEN to generate the correct collabration diagram
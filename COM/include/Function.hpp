@@ -27,12 +27,29 @@ class Function {
  public:
   enum { MAX_NUMARG = 14 };
   enum { F_FUNC, C_FUNC, CPP_MEMBER };
+  /// Properties of an argument derived from its intention and data type.
+  enum {
+    ARG_LITERAL = 1,    ///< Passed by value (not an dataitem)
+    ARG_RAWDATA = 2,    ///< Address of the values of an dataitem
+    ARG_OPTIONAL = 4,   ///< Optional argument
+    ARG_INPUT = 8,      ///< Input ('i', 'b', 'I' or 'B')
+    ARG_OUTPUT = 16,    ///< Output ('o', 'b', 'O' or 'B')
+    ARG_CHARS = 32,     ///< Character or string literal
+    ARG_STRING = 64,    ///< String literal
+    ARG_MPI_COMMC = 128,  ///< C MPI communicator
+    ARG_MPI_COMMF = 256   ///< Fortran MPI communicator
+  };
 
   /** \name Constructors
    * \{
    */
   /// Default constructor.
-  Function() : _ptr(NULL), _attr(NULL), _comm(MPI_COMM_NULL), _ftype(C_FUNC) {}
+  Function()
+      : _ptr(NULL),
+        _special(false),
+        _attr(NULL),
+        _comm(MPI_COMM_NULL),
+        _ftype(C_FUNC) {}
   /** Create a function object with physical address p.
    *  \param p physical address of the function.
    *  \param s the intentions of the arguments.
@@ -57,14 +74,18 @@ class Function {
         _types(t, t + s.size()),
         _attr(a),
         _comm(MPI_COMM_NULL),
-        _ftype(b ? F_FUNC : C_FUNC) {}
+        _ftype(b ? F_FUNC : C_FUNC) {
+    init_arg_flags();
+  }
   Function(Member_func_ptr p, const std::string &s, const int *t, DataItem *a)
       : _mem_ptr(p),
         _intents(s),
         _types(t, t + s.size()),
         _attr(a),
         _comm(MPI_COMM_NULL),
-        _ftype(CPP_MEMBER) {}
+        _ftype(CPP_MEMBER) {
+    init_arg_flags();
+  }
   //\}
 
   /** \name Access methods
@@ -101,6 +122,11 @@ class Function {
   bool is_fortran() const { return _ftype == F_FUNC; }
   COM_Type data_type(int i) const { return _types[i]; }
   char intent(int i) const { return _intents[i]; }
+  /// Get the ARG_* flags of the ith argument.
+  int arg_flags(int i) const { return _flags[i]; }
+  /// Check whether any literal argument is a character, a string, or an
+  /// MPI communicator, which call_function may need to convert.
+  bool has_special_literals() const { return _special; }
 
   void set_communicator(MPI_Comm c) { _comm = c; }
   MPI_Comm communicator() const { return _comm; }
@@ -398,6 +424,41 @@ class Function {
 
   //\}
  private:
+  /// Precompute the properties of the arguments, so that they need not
+  /// be decoded from the intents and types on every call.
+  void init_arg_flags() {
+    COM_assertion_msg(_intents.size() <= MAX_NUMARG + 1, "Too many arguments");
+    _special = false;
+    for (int i = 0, n = _intents.size(); i < n; ++i) {
+      int f = 0;
+      if (is_literal(i)) f |= ARG_LITERAL;
+      if (is_rawdata(i)) f |= ARG_RAWDATA;
+      if (is_optional(i)) f |= ARG_OPTIONAL;
+      if (is_input(i)) f |= ARG_INPUT;
+      if (is_output(i)) f |= ARG_OUTPUT;
+      if (f & ARG_LITERAL) {
+        switch (_types[i]) {
+          case COM_STRING:
+            f |= ARG_STRING;
+            // fall through
+          case COM_CHAR:
+          case COM_CHARACTER:
+            f |= ARG_CHARS;
+            break;
+          case COM_MPI_COMMC:
+            f |= ARG_MPI_COMMC;
+            break;
+          case COM_MPI_COMMF:
+            f |= ARG_MPI_COMMF;
+            break;
+          default:;
+        }
+        if (f & (ARG_CHARS | ARG_MPI_COMMC | ARG_MPI_COMMF)) _special = true;
+      }
+      _flags[i] = f;
+    }
+  }
+
   void validate_object(void *a1) {
     int ierr = reinterpret_cast<COM_Object *>(a1)->validate_object(a1);
     switch (ierr) {
@@ -418,6 +479,8 @@ class Function {
   std::string _intents;          ///< Intention of the argument. Its length
                                  ///< indicates the number of arguments
   std::vector<COM_Type> _types;  ///< Data type of the arguments.
+  short _flags[MAX_NUMARG + 1];  ///< ARG_* flags of the arguments.
+  bool _special;                 ///< Whether any literal needs conversion
   DataItem *_attr;               ///< Member function
   MPI_Comm _comm;
   int _ftype;  ///< Indicate the type of the function
@@ -0,0 +1,160 @@
+//
+//  Copyright@2013, Illinois Rocstar LLC. All rights reserved.
+//
+//  See LICENSE file included with this source or
+//  (opensource.org/licenses/NCSA) for license information.
+//
+
+/** \file Tracer.hpp
+ * Contains the prototypes for the Tracer object, which records timelines of
+ * COM function calls and user-defined regions.
+ * @see Tracer.C COM_base.hpp
+ */
+
+#ifndef __COM_TRACER_H__
+#define __COM_TRACER_H__
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "com_basic.h"
+#include "commpi.h"
+
+COM_BEGIN_NAME_SPACE
+
+/** A Tracer records an event for each COM function call and each
+ *  user-defined region that completes while tracing is on. Each thread
+ *  records into its own ring buffer of fixed capacity, so recording takes
+ *  no lock; when a buffer is full, the oldest events are overwritten.
+ *  Call counts and times of each function and region are accumulated
+ *  separately, so they are exact even if events were overwritten.
+ *
+ *  Only completed calls and regions are recorded: those still running
+ *  when write() is called do not appear, and a region that began before
+ *  tracing was last enabled is dropped. A function call that spans
+ *  enable(true) is recorded with its start on the previous timeline.
+ *
+ *  write() gathers the events of all processes and writes them in the
+ *  Chrome trace event format, which can be viewed in chrome://tracing or
+ *  Perfetto, with one timeline per process and thread, together with the
+ *  minimum, maximum and average time of each function over the processes.
+ *  It must not be called while other threads are recording.
+ */
+class Tracer {
+ public:
+  /// A completed call of a function or region.
+  struct Event {
+    double start;  ///< Time of entry in seconds since tracing was enabled.
+    double end;    ///< Time of exit in seconds since tracing was enabled.
+    int id;        ///< Function handle if positive, or minus region ID.
+    int depth;     ///< Depth of the call.
+    int npanes;    ///< Number of panes of the first dataitem argument.
+    long nitems;   ///< Number of items of the first dataitem argument.
+  };
+
+  enum { DEFAULT_CAPACITY = 65536 };
+
+  Tracer();
+  ~Tracer();
+
+  /// Turn tracing on or off. When turned on, all previous events are
+  /// discarded and each thread records at most capacity events. Threads
+  /// may be recording meanwhile: the buffers they hold are retired, not
+  /// freed, until the tracer is destroyed.
+  void enable(bool on, int capacity = 0);
+
+  bool enabled() const { return _on; }
+
+  /// Seconds since tracing was enabled.
+  double now() const {
+    return std::chrono::duration<double>(Clock::now() - _t0).count();
+  }
+
+  /// Record a completed call of function handle id.
+  void record(int id, int depth, double start, double end, int npanes = 0,
+              long nitems = -1);
+
+  /// Get the ID of a region with the given name, creating it if needed.
+  int region(const std::string &name);
+
+  /// Begin and end a region in the calling thread. Regions must be
+  /// properly nested within a thread.
+  void begin_region(int rid);
+  void end_region(int rid);
+
+  /** Write the events into file fname on the root of comm. This is a
+   *  collective call if MPI is initialized.
+   *  \param fname  name of the output file.
+   *  \param fnames names of the functions, indexed by their handles.
+   *  \param comm   communicator of the processes to gather.
+   */
+  void write(const std::string &fname, const std::vector<std::string> &fnames,
+             MPI_Comm comm);
+
+ private:
+  typedef std::chrono::steady_clock Clock;
+
+  /// Accumulated calls and time of a function or region.
+  struct Stat {
+    Stat() : count(0), time(0) {}
+    long count;
+    double time;
+  };
+
+  /// The events of a thread.
+  struct Buffer {
+    std::vector<Event> events;  ///< Ring buffer of events.
+    unsigned long nrecorded;    ///< Number of events recorded so far.
+    std::vector<Stat> fstats;   ///< Statistics indexed by function handle.
+    std::vector<Stat> rstats;   ///< Statistics indexed by region ID.
+    std::vector<std::pair<int, double> > open;  ///< Open regions.
+    int tid;                                    ///< Index of the thread.
+  };
+
+  /// Get the buffer of the calling thread, creating it if needed.
+  Buffer *buffer();
+
+  void push(Buffer *b, const Event &e);
+
+  // Disable copying.
+  Tracer(const Tracer &);
+  Tracer &operator=(const Tracer &);
+
+  std::atomic<bool> _on;                ///< Whether tracing is on.
+  int _capacity;                        ///< Capacity of each buffer.
+  std::atomic<unsigned long> _serial;   ///< Identifies current buffers.
+  Clock::time_point _t0;                ///< Time when tracing was enabled.
+  double _wt0;                          ///< Wall-clock time of _t0.
+  std::vector<Buffer *> _bufs;          ///< Current buffers of all threads.
+  std::vector<Buffer *> _retired;       ///< Buffers discarded by enable.
+  std::vector<std::string> _rnames;   ///< Names of regions.
+  std::map<std::string, int> _rids;  ///< IDs of regions.
+  std::mutex _mutex;  ///< Guards the buffer lists and the regions.
+};
+
+/// Traces a region for the lifetime of the object if t is not NULL and
+/// tracing is on.
+class Trace_region {
+ public:
+  Trace_region(Tracer *t, const std::string &name)
+      : _t(t && t->enabled() ? t : NULL), _rid(_t ? _t->region(name) : 0) {
+    if (_t) _t->begin_region(_rid);
+  }
+  ~Trace_region() {
+    if (_t) _t->end_region(_rid);
+  }
+
+ private:
+  Trace_region(const Trace_region &);
+  Trace_region &operator=(const Trace_region &);
+
+  Tracer *_t;
+  int _rid;
+};
+
+COM_END_NAME_SPACE
+
+#endif
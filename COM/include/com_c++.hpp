@@ -135,6 +135,17 @@ inline void COM_delete_pane(const std::string &str, int pid) {
 }
 #endif
 
+inline void COM_set_pane_directory(const char *wname, int distributed) {
+  COM_get_com()->set_pane_directory(wname, distributed);
+}
+
+#ifndef C_ONLY
+inline void COM_set_pane_directory(const std::string &wname,
+                                   int distributed) {
+  COM_get_com()->set_pane_directory(wname, distributed);
+}
+#endif
+
 inline void COM_new_dataitem(const char *wa_str, const char loc, const int type,
                              int ncomp, const char *unit) {
   COM_get_com()->new_dataitem(wa_str, loc, type, ncomp, unit);
@@ -725,6 +736,15 @@ inline void COM_print_profile(const std::string &fname,
 }
 #endif
 
+// Tracing tools
+inline void COM_set_tracing(int i, int capacity = 0) {
+  COM_get_com()->set_tracing(i, capacity);
+}
+
+inline void COM_print_trace(const char *fname) {
+  COM_get_com()->print_trace(fname);
+}
+
 inline int COM_get_sizeof(const COM_Type type, int c) {
   return COM::DataItem::get_sizeof(type, c);
 }
@@ -79,6 +79,13 @@ void COM_delete_window(const char *str);
  *    pane_id is the id of a pane which was created before. */
 void COM_delete_pane(const char *w_str, const int pane_id);
 
+/* Select a distributed pane directory for a window if distributed is
+ * nonzero, or a replicated one otherwise, from the next call to
+ * COM_window_init_done with pane changes. With a distributed directory,
+ * each process knows only the owners of its panes and of those it looks
+ * up, such as the neighbors in a pconn. */
+void COM_set_pane_directory(const char *w_str, int distributed);
+
 /* This marks the end of the initialization of a window,
  *    w_str is a window's name. */
 void COM_window_init_done(const char *w_str, int pane_changed);
@@ -251,6 +258,8 @@ void COM_set_verbose(int i);
 void COM_set_profiling(int i);
 void COM_set_profiling_barrier(int hdl, MPI_Comm comm);
 void COM_print_profile(const char *fname, const char *header);
+void COM_set_tracing(int i, int capacity);
+void COM_print_trace(const char *fname);
 /*\}*/
 
 /** \name Miscellaneous
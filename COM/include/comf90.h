@@ -1814,6 +1814,14 @@
            CHARACTER(*), INTENT(IN) :: fname, header
          END SUBROUTINE COM_PRINT_PROFILE
 
+         SUBROUTINE COM_SET_TRACING( level)
+           INTEGER, INTENT(IN) :: level
+         END SUBROUTINE COM_SET_TRACING
+
+         SUBROUTINE COM_PRINT_TRACE( fname)
+           CHARACTER(*), INTENT(IN) :: fname
+         END SUBROUTINE COM_PRINT_TRACE
+
          FUNCTION COM_GET_SIZEOF(TYPE, COUNT)
            INTEGER, INTENT(IN) :: TYPE, COUNT
            INTEGER :: COM_GET_SIZEOF
@@ -27,15 +27,13 @@ class COM_map {
   ~COM_map() {}
 
   /// Insert an object into the table.
-  int add_object(std::string name, Object t, bool is_const = false);
+  int add_object(const std::string &name, Object t, bool is_const = false);
 
   /// Remove an object from the table.
   void remove_object(std::string name, bool is_const = false);
 
   /// whether the object mutable
-  bool is_immutable(int i) const {
-    return names[i].find(" (const)") != std::string::npos;
-  }
+  bool is_immutable(int i) const { return immutables[i]; }
 
   /// Access an object using its handle.
   const Object &operator[](int i) const {
@@ -68,22 +66,29 @@ class COM_map {
   I2O i2o;                         ///< Mapping from index to objects
   N2I n2i;                         ///< Mapping from names to indices
   std::vector<std::string> names;  ///< Name of the objects
+  std::vector<char> immutables;    ///< Whether the objects are immutable
 };
 
 template <class Object>
-int COM_map<Object>::add_object(std::string name, Object t, bool is_const) {
-  if (is_const) name.append(" (const)");
-
-  N2I::iterator it = n2i.find(name);
-  int i = (it == n2i.end()) ? -1 : it->second;
-
-  if (i > 0) {
+int COM_map<Object>::add_object(const std::string &n, Object t,
+                                bool is_const) {
+  std::string cname;
+  if (is_const) cname = n + " (const)";
+  const std::string &name = is_const ? cname : n;
+
+  // Look up the name and insert it with a single search of the map.
+  N2I::iterator it = n2i.lower_bound(name);
+  int i;
+
+  if (it != n2i.end() && it->first == name) {
+    i = it->second;
     i2o[i] = t;
   } else {
     i = i2o.size();
-    n2i[name] = i;
+    n2i.insert(it, N2I::value_type(name, i));
     i2o.push_back(t);
     names.push_back(name);
+    immutables.push_back(is_const);
   }
   return i;
 }
@@ -105,6 +110,7 @@ void COM_map<Object>::remove_object(std::string name, bool is_const) {
   i2o.erase(oi);
   std::vector<std::string>::iterator ni = names.begin() + i;
   names.erase(ni);
+  immutables.erase(immutables.begin() + i);
 }
 
 class Function;
@@ -34,6 +34,19 @@ struct ActionData {
 
 typedef std::vector<ActionData> ActionDataList;
 
+/**
+ * How an Action may run alongside other actions when a Scheduler runs
+ * independent actions concurrently (see Scheduler::set_threads()).
+ */
+enum ActionConcurrency {
+  ACTION_SERIAL = 0,      ///< Run on the calling thread, one at a time.
+  ACTION_THREAD_SAFE = 1, ///< May run on a worker thread concurrently.
+                          ///< COM functions it calls must only access
+                          ///< its dataitems, without MPI collectives.
+  ACTION_COLLECTIVE = 2   ///< Makes MPI collective calls: run on the calling
+                          ///< thread, in topological order on every process.
+};
+
 /**
  * Represents an action taken during a simulation process.
  *
@@ -126,6 +139,17 @@ public:
    */
   void set_name(const std::string &name) { action_name = name; }
 
+  /**
+   * Get how the Action may run alongside others. Default ACTION_SERIAL.
+   * @return concurrency of the Action
+   */
+  ActionConcurrency concurrency() const { return action_concurrency; }
+  /**
+   * Declare how the Action may run alongside others.
+   * @param c concurrency of the Action
+   */
+  void set_concurrency(ActionConcurrency c) { action_concurrency = c; }
+
 protected:
   /**
    * Get DataItem handle if OUT, or const handle if IN, from COM.
@@ -138,6 +162,7 @@ protected:
 protected:
   std::string action_name; ///< Action name
   ActionDataList action_data; ///< List of ActionData
+  ActionConcurrency action_concurrency; ///< How the Action may run
 };
 
 #endif // _IMPACT_ACTION_H_
@@ -13,6 +13,7 @@
 #ifndef _AGENT_H_
 #define _AGENT_H_
 
+#include <array>
 #include <string>
 #include <utility>
 #include <vector>
@@ -498,6 +499,33 @@ public:
    */
   bool check_convergence_helper(int cur_hdl, int pre_hdl, double tol,
                                 const std::string &attr) const;
+  /**
+   * Register a pair of DataItems to be checked for PC convergence by
+   * Coupling::check_convergence, in addition to check_convergence()
+   * @param cur_hdl handle to current value
+   * @param pre_hdl handle to previous value
+   * @param tol tolerance to accept convergence
+   * @param attr name of attribute
+   */
+  void register_convergence(int cur_hdl, int pre_hdl, double tol,
+                            const std::string &attr);
+  /**
+   * Get the number of norms of the registered convergence pairs
+   * @return two norms per registered pair
+   */
+  std::size_t size_of_convergence_norms() const { return 2 * pc_convs.size(); }
+  /**
+   * Compute the local (not reduced) squared norms ||cur|| and ||cur - pre||
+   * of every registered convergence pair
+   * @param nrms array of size_of_convergence_norms() values
+   */
+  void compute_convergence_norms(double *nrms) const;
+  /**
+   * Check convergence of the registered pairs from the global norms
+   * @param nrms norms from compute_convergence_norms summed over processes
+   * @return true if all ratios are below tolerance
+   */
+  bool check_convergence_norms(const double *nrms) const;
   ///@}
 
   /**
@@ -630,6 +658,14 @@ protected:
   std::vector<std::array<int, 2>>
       pc_hdls; ///< Handles for DataItems to be stored/restored for PC
                ///< iterations as pair: (live, backup)
+
+  struct PCConvergence {
+    int cur_hdl;      ///< Handle to current value
+    int pre_hdl;      ///< Handle to previous value
+    double tol;       ///< Tolerance to accept convergence
+    std::string attr; ///< Name of attribute
+  };
+  std::vector<PCConvergence> pc_convs; ///< Pairs checked for PC convergence
   ///@}
 
   /**
@@ -725,6 +761,16 @@ private:
    * Create internal surf_all buffer
    */
   void create_buffer_internal();
+  /**
+   * Print the ratio ||cur - pre|| / ||cur|| and compare it with tolerance
+   * @param nrm_val global norm of current value
+   * @param nrm_diff global norm of difference
+   * @param tol tolerance to accept convergence
+   * @param attr name of attribute
+   * @return true if ratio is below tolerance
+   */
+  bool check_convergence_ratio(double nrm_val, double nrm_diff, double tol,
+                               const std::string &attr) const;
 
   /**
    * Run the BC init action scheduler. Called by PhysicsAction::run()
@@ -117,8 +117,11 @@ public:
    */
   void init_convergence(int iPredCorr_);
   /**
-   * Check for PC convergence
-   * @return
+   * Check for PC convergence. The pairs registered with
+   * Agent::register_convergence of all agents are checked with a single
+   * reduction over the Coupling communicator, then Agent::check_convergence
+   * is called for each agent.
+   * @return true if converged
    */
   bool check_convergence();
   ///@}
@@ -29,6 +29,8 @@ public:
   static int sum_scalar_MPI;
   static int nrm2_scalar_MPI;
   static int maxof_scalar;
+  static int extrapolate_linear;
+  static int backup;
 };
 
 #endif //_ROCBLAS_H_
@@ -6,6 +6,7 @@
 #include "Action.h"
 
 class Scheduler;
+class ThreadPool;
 typedef void (Scheduler::*Scheduler_voidfn1_t)(double);
 
 /**
@@ -22,6 +23,17 @@ typedef void (Scheduler::*Scheduler_voidfn1_t)(double);
  *
  * The functions init_actions(), run_actions(), and finalize_actions()
  * correspond to the Action equivalents.
+ *
+ * By default, actions run one after another in the scheduled order. After
+ * set_threads(), run_actions() instead starts each action as soon as the
+ * actions it reads from, and the earlier actions that access the same
+ * dataitems, have finished, so that independent actions overlap.
+ * Only actions declared ACTION_THREAD_SAFE run on the worker threads; the
+ * others run on the calling thread, and ACTION_COLLECTIVE actions keep their
+ * scheduled order relative to each other so that every process makes its
+ * MPI collective calls in the same order. ACTION_THREAD_SAFE actions may
+ * call COM functions, as long as those functions only touch the dataitems
+ * the actions declare and make no MPI collective calls.
  */
 class Scheduler {
 public:
@@ -82,6 +94,19 @@ public:
    */
   void finalize_actions();
 
+  /**
+   * Set the number of worker threads used by run_actions(). With 0 or 1
+   * (the default), actions run one after another in the scheduled order.
+   * init_actions() and finalize_actions() always run in order.
+   * @param n number of worker threads
+   */
+  void set_threads(int n);
+  /**
+   * Get the number of worker threads used by run_actions().
+   * @return number of worker threads
+   */
+  int threads() const { return nthreads; }
+
   /**
    * Print to file in GDL.
    * @param fname file name
@@ -231,7 +256,21 @@ protected:
 
   bool verbose; ///< flag: verbosity (Default: false)
 
+  int nthreads;     ///< number of worker threads for run_actions()
+  ThreadPool *thread_pool; ///< worker threads, created on first parallel run
+
 private:
+  /**
+   * Run actions concurrently as their inputs become available.
+   * @param t current time
+   * @param dt time step
+   * @param alpha interpolation sub step
+   */
+  void run_parallel(double t, double dt, double alpha);
+
+  std::vector<std::vector<int>> succs; ///< successors of each sorted action
+  std::vector<int> npreds; ///< number of predecessors of each sorted action
+
   /**
    * Helper function to print ActionItem to C-style stream
    * @param f C stream
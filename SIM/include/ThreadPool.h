@@ -0,0 +1,81 @@
+#ifndef _IMPACT_THREADPOOL_H_
+#define _IMPACT_THREADPOOL_H_
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * A fixed set of worker threads that run submitted tasks.
+ *
+ * Each worker owns a double-ended queue of tasks. A task submitted from a
+ * worker goes to the back of that worker's queue, and the worker takes its
+ * next task from the back as well, so a chain of dependent tasks stays on
+ * one thread. An idle worker steals from the front of the other queues.
+ * Tasks submitted from other threads are dealt round-robin to the queues.
+ */
+class ThreadPool {
+public:
+  typedef std::function<void()> Task;
+
+  /**
+   * Start the worker threads.
+   * @param nthreads number of worker threads (at least 1)
+   */
+  explicit ThreadPool(int nthreads);
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  /**
+   * Stop the worker threads after all queued tasks have run.
+   */
+  ~ThreadPool();
+
+  /**
+   * Queue a task to be run by a worker.
+   * @param task the task
+   */
+  void submit(Task task);
+
+  /**
+   * Get the number of worker threads.
+   * @return number of worker threads
+   */
+  int size() const { return static_cast<int>(workers.size()); }
+
+private:
+  /**
+   * The tasks of a worker.
+   */
+  struct Queue {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+  };
+
+  /**
+   * Main loop of worker id.
+   */
+  void work(int id);
+  /**
+   * Take a task from the back of queue id, or steal one from the front of
+   * another queue.
+   * @return true if a task was found
+   */
+  bool take(int id, Task &task);
+
+  std::vector<std::unique_ptr<Queue>> queues;
+  std::vector<std::thread> workers;
+
+  std::mutex mutex;            ///< guards npending, next, and stop
+  std::condition_variable cv;  ///< signaled when a task is queued or on stop
+  int npending;                ///< number of queued tasks not yet taken
+  unsigned int next;           ///< next queue for tasks from outside the pool
+  bool stop;                   ///< flag: workers should exit when idle
+};
+
+#endif // _IMPACT_THREADPOOL_H_
@@ -45,7 +45,10 @@ extern "C" void SimIN_unload_module(const char *name);
 class Rocin : public COM_Object {
  public:
   /// Default constructor
-  Rocin() : m_is_local(NULL), m_base(0), m_offset(0) {}
+  Rocin() : m_is_local(NULL), m_base(0), m_offset(0) {
+    m_options["scan"] = "all";
+    m_options["scanindex"] = "off";
+  }
 
   /// Pointer to a function to determine locality of a pane.
   typedef void (*RulesPtr)(const int &pane_id, const int &comm_rank,
@@ -154,6 +157,22 @@ class Rocin : public COM_Object {
   void read_parameter_file(const char *file_name, const char *window_name,
                            const MPI_Comm *comm = NULL);
 
+  /** Set an option for Rocin.
+   *
+   * "scan" selects which processes open the files to read their metadata:
+   * "all" (the default) has every process scan all of its files;
+   * "partitioned" divides the files of all processes among the processes
+   * and "node" among one process per node, after which the metadata are
+   * exchanged with an allgather. With "scanindex" set to "on", a shared
+   * scan by read_by_control_file caches the metadata in the file
+   * <control_file_name>.idx and reuses it while the files are unchanged.
+   * Shared scans are collective over the communicator.
+   *
+   * \param option_name the option name: "scan" or "scanindex".
+   * \param option_val the option value.
+   */
+  void set_option(const char *option_name, const char *option_val);
+
   //\}
 
  protected:
@@ -219,6 +238,8 @@ class Rocin : public COM_Object {
   std::set<int> m_pane_ids;
   int m_base;
   int m_offset;
+  std::map<std::string, std::string> m_options;
+  std::string m_index_file;  ///< Index of the files of a shared scan
 
 #ifdef USE_HDF4
   std::map<int32, COM_Type> m_HDF2COM;
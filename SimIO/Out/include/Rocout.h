@@ -8,6 +8,10 @@
 #define _ROCOUT_H_
 
 #include <map>
+#ifdef USE_PTHREADS
+#include <pthread.h>
+#include <deque>
+#endif  // USE_PTHREADS
 #include "com.h"
 #include "com_devel.hpp"
 
@@ -21,8 +25,13 @@ extern "C" void SimOUT_load_module(const char *name);
 extern "C" void SimOUT_unload_module(const char *name);
 //\}
 
+struct WriteAttrInfo;
+
 class Rocout : public COM_Object {
  public:
+  Rocout();
+  ~Rocout();
+
   /** \name User interface
    *  \{
    */
@@ -74,11 +83,14 @@ class Rocout : public COM_Object {
                     const char *mfile_pre = NULL, const MPI_Comm *comm = NULL,
                     const int *pane_id = NULL);
 
-  /** Wait for the completion of an asychronous write operation.
+  /** Wait for the completion of all the pending asychronous write
+   *  operations.
    */
   void sync();
 
-  /** Generate a control file for Rocin.
+  /** Generate a control file for Rocin. It is collective over the
+   *  communicator of the window, and the process of rank 0 in it writes
+   *  the file.
    *
    * \param window_name The name of the Roccom window.
    * \param file_prfixes The prefixes of the data files.
@@ -89,9 +101,24 @@ class Rocout : public COM_Object {
                                 const char *control_file_name);
 
   /** Set an option for Rocout, such as controlling the output format.
+   *
+   * The options "aggregators" and "groupsize" turn on aggregated output:
+   * the processes are divided into groups, either "aggregators" groups of
+   * consecutive ranks on each node or groups of "groupsize" consecutive
+   * ranks, and the lowest rank of each group gathers the panes of the group
+   * and writes them into one file named after its own rank. Both default to
+   * 0, which writes one file per process. Aggregated writes and
+   * write_rocin_control_file are collective over the communicator.
+   *
+   * The option "ranges" ("on" by default) controls whether the minimum and
+   * maximum of each array are stored with it.  They are found while the
+   * data is staged for writing; "off" saves that scan for arrays that need
+   * no staging.  Empty and null arrays are marked either way.
    *
    * \param option_name the option name: "format", "async", "mode",
-   *        "localdir", "rankwidth", "pnidwidth", "separator" or "errorhandle".
+   *        "localdir", "rankdir", "rankwidth", "pnidwidth", "separator",
+   *        "errorhandle", "ghosthandle", "aggregators", "groupsize" or
+   *        "ranges".
    * \param option_val the option value.
    */
   void set_option(const char *option_name, const char *option_val);
@@ -150,21 +177,88 @@ class Rocout : public COM_Object {
    */
   static void *write_dataitem_internal(void *attrInfo);
 
+  /** Writes the dataitem now, or queues it for a writer thread if the
+   *  "async" option is on.
+   *
+   * \param ai Information on what to write and where to write it.
+   */
+  void submit(WriteAttrInfo *ai);
+
+  /** Splits comm into the groups for aggregated output. Returns the rank
+   *  in comm of the aggregator of the calling process and sets group to the
+   *  communicator of its group, or returns -1 if aggregation is off. The
+   *  group is cached per comm and freed by the destructor, so comm must
+   *  outlive the module.
+   */
+  int aggregation_group(MPI_Comm comm, MPI_Comm *group);
+
+  /** Gathers the panes to be written by a request onto the aggregator of
+   *  the group, which then writes them on behalf of the group. Returns
+   *  false if the calling process has nothing left to write.
+   *
+   * \param ai Information on what to write and where to write it.
+   */
+  bool gather(WriteAttrInfo *ai);
+
   /** Builds a filename from the given prefix and rank.
    *
+   * \param options The options of the module or of a queued request.
    * \param pre Filename prefix.
    * \param rank The rank of this MPI process.
    * \param pPaneId A pointer to the pane id.
    * \param check Check for an existing file.
    */
-  std::string get_fname(const std::string &pre, int rank = -1,
-                        const int paneId = 0, bool check = false);
+  static std::string get_fname(std::map<std::string, std::string> &options,
+                               const std::string &pre, int rank = -1,
+                               const int paneId = 0, bool check = false);
   //\}
 
+#ifdef USE_PTHREADS
+  /** \name Asynchronous writing
+   * \{
+   */
+  /** Copies the data of a dataitem into a staging window, which is
+   *  reused across calls as long as the layout of the dataitem is
+   *  unchanged. Returns the dataitem in the staging window.
+   */
+  const COM::DataItem *take_snapshot(const COM::DataItem *attr);
+
+  /// Returns the staging window of a written snapshot for reuse.
+  void release_snapshot(const COM::DataItem *snap);
+
+  /// Queues a write request, waiting while the queue is full.
+  void enqueue(WriteAttrInfo *ai);
+
+  /// Stops the writer threads after the queue has been drained.
+  void stop_writers();
+
+  /// Main loop of the writer threads.
+  static void *writer_main(void *rout);
+  //\}
+#endif  // USE_PTHREADS
+
   std::map<std::string, std::string> _options;
+
+  /// A group for aggregated output, with the options it was split with.
+  struct Aggregation_group {
+    MPI_Comm group;  ///< Communicator of the group
+    int agg;         ///< Rank of the aggregator in the parent communicator
+    int naggs;       ///< Value of the "aggregators" option
+    int gsize;       ///< Value of the "groupsize" option
+  };
+  /// Groups for aggregated output, keyed by their parent communicator.
+  std::map<MPI_Comm, Aggregation_group> _agg_groups;
 #ifdef USE_PTHREADS
-  std::vector<pthread_t> _writers;
-  static Semaphore _writesem;
+  std::vector<pthread_t> _writers;    ///< Writer threads
+  std::deque<WriteAttrInfo *> _queue;  ///< Queued write requests
+  int _pending;                       ///< Queued or running write requests
+  bool _stopping;                     ///< Whether the writers should exit
+  pthread_mutex_t _lock;              ///< Protects the members above
+  pthread_cond_t _cond;               ///< Signals any change of them
+
+  /// Idle staging windows, keyed by the full name of the dataitem.
+  std::multimap<std::string, COM::DataItem *> _staging;
+  pthread_mutex_t _staging_lock;  ///< Protects _staging
 #endif  // USE_PTHREADS
 };
 
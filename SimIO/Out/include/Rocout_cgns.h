@@ -9,10 +9,73 @@
  *  Declaration of Rocout CGNS routines.
  */
 #if !defined(_ROCOUT_CGNS_H)
+#define _ROCOUT_CGNS_H
 
+#include <map>
 #include <string>
+#include <utility>
+#include <vector>
 #include "com.h"
 
+/**
+ ** The open files of a sequence of CGNS writes.
+ **
+ ** A session keeps each file open until it is destroyed, and remembers the
+ ** indices of the Base_t, Zone_t and FlowSolution_t nodes and the time
+ ** values found or written in it, so that writing many panes into a file
+ ** opens and scans the file only once.
+ **/
+class CGNS_write_session {
+ public:
+  explicit CGNS_write_session(const std::string &errorhandle)
+      : m_errorhandle(errorhandle) {}
+
+  /// Close all the files of the session.
+  ~CGNS_write_session();
+
+  /**
+   ** Return the handle of a file, opening it for modification if needed.
+   **
+   ** \param fname The name of the file. (Input)
+   ** \param create Whether to create an empty file if the file is not open
+   **               yet. (Input)
+   **/
+  int open(const std::string &fname, bool create);
+
+  /// Return the handle of a file opened by the session, or -1.
+  int find(const std::string &fname) const;
+
+  /**
+   ** Find a child node by name.
+   **
+   ** \param fn The CGNS file number. (Input)
+   ** \param parent A key for the parent node. (Input)
+   ** \param name The name of the node. (Input)
+   ** \param listed Whether the children of the parent were cached. (Output)
+   ** \returns The index of the node, or 0 if it is not cached.
+   **/
+  int node(int fn, const std::string &parent, const std::string &name,
+           bool &listed) const;
+
+  /// Cache the index of a child node, unless a node of the same name was.
+  void set_node(int fn, const std::string &parent, const std::string &name,
+                int index);
+
+  /// Mark the children of the parent as cached.
+  void set_listed(int fn, const std::string &parent);
+
+  /// The time values of a base, and whether they were cached before.
+  std::vector<double> &times(int fn, int B, bool &cached);
+
+ private:
+  typedef std::pair<int, std::string> Key;
+
+  std::string m_errorhandle;
+  std::map<std::string, int> m_files;                  ///< Open files
+  std::map<Key, std::map<std::string, int> > m_nodes;  ///< Listed children
+  std::map<std::pair<int, int>, std::vector<double> > m_times;
+};
+
 /**
  ** Write the data for the given attribute to file.
  **
@@ -28,10 +91,17 @@
  ** \param ghosthandle "ignore" or "write" on ghost data.
  ** \param errorhandle "ignore", "warn", or "abort" on errors.
  ** \param mode Write == 0, append == 1. (Input)
+ ** \param findRanges Whether to scan the data for the Range, MagnitudeRange
+ **                   and TraceRange descriptors.  Empty and null arrays are
+ **                   always marked. (Input)
+ ** \param session The session that keeps the files open, or NULL to open
+ **                and close them in this call. (Input)
  **/
 void write_dataitem_CGNS(const std::string &fname, const std::string &mfile,
                          const COM::DataItem *attr, const char *material,
                          const char *timelevel, int pane_id,
                          const std::string &ghosthandle,
-                         const std::string &errorhandle, int mode);
+                         const std::string &errorhandle, int mode,
+                         bool findRanges = true,
+                         CGNS_write_session *session = NULL);
 #endif  // !defined(_ROCOUT_CGNS_H)
@@ -13,6 +13,7 @@
 void write_dataitem_HDF4(const std::string &fname, const std::string &mfile,
                          const COM::DataItem *attr, const char *material,
                          const char *timelevel, int pane_id,
-                         const std::string &errorhandle, int mode);
+                         const std::string &errorhandle, int mode,
+                         bool ranges = true);
 
 #endif  // !defined(_ROCOUT_HDF4_H)
@@ -149,6 +149,18 @@ class Rocblas {
   static void axpy_scalar(const void *a, const DataItem *x, const DataItem *y,
                           DataItem *z);
 
+  /// Fused linear extrapolation z = y + a * (y - x) (a is a scalar pointer).
+  /// If g is present, computes z = y + a * limit1(g, (y - x) / h) instead.
+  static void extrapolate_linear(const DataItem *x, const DataItem *y,
+                                 const void *a, DataItem *z,
+                                 const DataItem *g = NULL,
+                                 const void *h = NULL);
+
+  /// Fused backup, which computes g = (x - y) / h if g is present (g = 0
+  /// if h is not positive), and then copies x into y.
+  static void backup(const DataItem *x, DataItem *y, const void *h,
+                     DataItem *g = NULL);
+
  protected:
   ///  Performs the operation:  z = x op y
   template <class FuncType, int ytype>
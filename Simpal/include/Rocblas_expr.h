@@ -0,0 +1,387 @@
+//
+//  Copyright@2013, Illinois Rocstar LLC. All rights reserved.
+//
+//  See LICENSE file included with this source or
+//  (opensource.org/licenses/NCSA) for license information.
+//
+
+/** \file Rocblas_expr.h
+ *  Expression templates on top of the Rocblas data model.
+ *
+ *  An expression such as
+ *  \code
+ *    Rocblas_expr::Item x(xattr), y(yattr), z(zattr);
+ *    z = (x - y) / dt;
+ *    double r = Rocblas_expr::nrm2(x - y, &comm);
+ *  \endcode
+ *  builds a tree of lightweight nodes, which is evaluated in a single loop
+ *  per pane without intermediate dataitems. Reductions are accumulated in
+ *  the same loop and then combined with a single MPI_Allreduce.
+ *
+ *  Only panel dataitems of type double are supported. All the dataitems in
+ *  an expression must have the same numbers of panes, components, and
+ *  items per pane. Like Rocblas::nrm2, nrm2 returns the squared 2-norm.
+ */
+
+#ifndef _ROCBLAS_EXPR_H_
+#define _ROCBLAS_EXPR_H_
+
+#include <string>
+#include <vector>
+
+#include "com.h"
+
+namespace Rocblas_expr {
+
+USE_COM_NAME_SPACE
+
+/// Base class of all the expressions, used to select the operators.
+template <class E>
+struct Expr {
+  const E &self() const { return static_cast<const E &>(*this); }
+};
+
+/** A leaf referring to a panel dataitem.
+ *
+ *  An Item is bound to one pane at a time by bind(). Afterwards,
+ *  operator[] accesses the values as a flat array if contiguous(), and
+ *  operator() accesses the jth item of the cth component in general.
+ */
+class Item : public Expr<Item> {
+ public:
+  explicit Item(DataItem *a) : _attr(a), _writable(true) { init(); }
+  explicit Item(const DataItem *a)
+      : _attr(const_cast<DataItem *>(a)), _writable(false) {
+    init();
+  }
+
+  const DataItem *dataitem() const { return _attr; }
+  int size_of_components() const { return _ncomp; }
+  int size_of_panes() const { return _panes.size(); }
+
+  /// Binds to the kth local pane and returns its number of items.
+  int bind(int k) const {
+    const DataItem *pa = _panes[k]->dataitem(_attr->id());
+    for (int c = 0; c < _ncomp; ++c) {
+      const DataItem *pc =
+          _ncomp == 1 ? pa : _panes[k]->dataitem(_attr->id() + c + 1);
+      _comps[c] = reinterpret_cast<double *>(const_cast<void *>(pc->pointer()));
+      _strds[c] = pc->stride();
+    }
+    _contig = pa->stride() == _ncomp;
+    return pa->size_of_items();
+  }
+
+  bool contiguous() const { return _contig; }
+  double operator[](int i) const { return _comps[0][i]; }
+  double operator()(int j, int c) const { return _comps[c][j * _strds[c]]; }
+
+  /// Evaluates e and stores it into the dataitem.
+  template <class E>
+  Item &operator=(const Expr<E> &e);
+  Item &operator=(const Item &e) { return operator=<Item>(e); }
+
+ private:
+  void init() {
+    COM_assertion_msg(!_attr->is_windowed(),
+                      (std::string("Unsupported dataitem type in ") +
+                       _attr->fullname())
+                          .c_str());
+    COM_assertion_msg(_attr->data_type() == COM_DOUBLE ||
+                          _attr->data_type() == COM_DOUBLE_PRECISION,
+                      (std::string("Unsupported data type in ") +
+                       _attr->fullname())
+                          .c_str());
+    _attr->window()->panes(_panes);
+    _ncomp = _attr->size_of_components();
+    _comps.resize(_ncomp);
+    _strds.resize(_ncomp);
+    _contig = false;
+  }
+
+  DataItem *_attr;
+  bool _writable;
+  int _ncomp;
+  std::vector<Pane *> _panes;
+  // State of the pane that is currently bound
+  mutable std::vector<double *> _comps;
+  mutable std::vector<int> _strds;
+  mutable bool _contig;
+};
+
+/// A leaf holding a scalar, which is broadcast to all the items.
+class Scalar : public Expr<Scalar> {
+ public:
+  explicit Scalar(double v) : _v(v) {}
+
+  int size_of_components() const { return 0; }
+  int size_of_panes() const { return -1; }
+  int bind(int) const { return -1; }
+  bool contiguous() const { return true; }
+  double operator[](int) const { return _v; }
+  double operator()(int, int) const { return _v; }
+
+ private:
+  double _v;
+};
+
+// Combines the sizes (numbers of components, panes, or items) of two
+// subexpressions. A negative or zero size denotes a scalar.
+inline int combine_sizes(int l, int r, const char *what) {
+  COM_assertion_msg(l <= 0 || r <= 0 || l == r,
+                    (std::string("Numbers of ") + what +
+                     " do not match in expression")
+                        .c_str());
+  (void)what;  // Unused if assertions are disabled
+  return l > 0 ? l : r;
+}
+
+// Items are held by reference and the other nodes by value.
+template <class E>
+struct Node_ref {
+  typedef const E type;
+};
+template <>
+struct Node_ref<Item> {
+  typedef const Item &type;
+};
+
+/// A node applying a binary operator to two subexpressions.
+template <class Op, class L, class R>
+class Binary : public Expr<Binary<Op, L, R> > {
+ public:
+  Binary(const L &l, const R &r) : _l(l), _r(r) {}
+
+  int size_of_components() const {
+    return combine_sizes(_l.size_of_components(), _r.size_of_components(),
+                         "components");
+  }
+  int size_of_panes() const {
+    return combine_sizes(_l.size_of_panes(), _r.size_of_panes(), "panes");
+  }
+  int bind(int k) const {
+    const int nl = _l.bind(k), nr = _r.bind(k);
+    COM_assertion_msg(nl < 0 || nr < 0 || nl == nr,
+                      "Numbers of items do not match in expression");
+    return nl >= 0 ? nl : nr;
+  }
+  bool contiguous() const { return _l.contiguous() && _r.contiguous(); }
+  double operator[](int i) const { return Op::apply(_l[i], _r[i]); }
+  double operator()(int j, int c) const {
+    return Op::apply(_l(j, c), _r(j, c));
+  }
+
+ private:
+  typename Node_ref<L>::type _l;
+  typename Node_ref<R>::type _r;
+};
+
+/// A node applying a unary operator to a subexpression.
+template <class Op, class A>
+class Unary : public Expr<Unary<Op, A> > {
+ public:
+  explicit Unary(const A &a) : _a(a) {}
+
+  int size_of_components() const { return _a.size_of_components(); }
+  int size_of_panes() const { return _a.size_of_panes(); }
+  int bind(int k) const { return _a.bind(k); }
+  bool contiguous() const { return _a.contiguous(); }
+  double operator[](int i) const { return Op::apply(_a[i]); }
+  double operator()(int j, int c) const { return Op::apply(_a(j, c)); }
+
+ private:
+  typename Node_ref<A>::type _a;
+};
+
+struct Plus {
+  static double apply(double a, double b) { return a + b; }
+};
+struct Minus {
+  static double apply(double a, double b) { return a - b; }
+};
+struct Times {
+  static double apply(double a, double b) { return a * b; }
+};
+struct Divides {
+  static double apply(double a, double b) { return a / b; }
+};
+// Same as Rocblas::limit1.
+struct Limit1 {
+  static double apply(double a, double b) {
+    if ((a >= 0 && b >= 0) || (a <= 0 && b <= 0))
+      return (a < 0 ? -a : a) < (b < 0 ? -b : b) ? a : b;
+    else
+      return 0;
+  }
+};
+struct Negate {
+  static double apply(double a) { return -a; }
+};
+struct Square {
+  static double apply(double a) { return a * a; }
+};
+
+#define ROCBLAS_EXPR_BINARY(func, Op)                                      \
+  template <class L, class R>                                              \
+  inline Binary<Op, L, R> func(const Expr<L> &l, const Expr<R> &r) {       \
+    return Binary<Op, L, R>(l.self(), r.self());                           \
+  }                                                                        \
+  template <class L>                                                       \
+  inline Binary<Op, L, Scalar> func(const Expr<L> &l, double r) {          \
+    return Binary<Op, L, Scalar>(l.self(), Scalar(r));                     \
+  }                                                                        \
+  template <class R>                                                       \
+  inline Binary<Op, Scalar, R> func(double l, const Expr<R> &r) {          \
+    return Binary<Op, Scalar, R>(Scalar(l), r.self());                     \
+  }
+
+ROCBLAS_EXPR_BINARY(operator+, Plus)
+ROCBLAS_EXPR_BINARY(operator-, Minus)
+ROCBLAS_EXPR_BINARY(operator*, Times)
+ROCBLAS_EXPR_BINARY(operator/, Divides)
+ROCBLAS_EXPR_BINARY(limit1, Limit1)
+
+#undef ROCBLAS_EXPR_BINARY
+
+template <class A>
+inline Unary<Negate, A> operator-(const Expr<A> &a) {
+  return Unary<Negate, A>(a.self());
+}
+
+template <class A>
+inline Unary<Square, A> sqr(const Expr<A> &a) {
+  return Unary<Square, A>(a.self());
+}
+
+template <class E>
+Item &Item::operator=(const Expr<E> &expr) {
+  const E &e = expr.self();
+  COM_assertion_msg(
+      _writable,
+      (std::string("Cannot assign to constant dataitem ") + _attr->fullname())
+          .c_str());
+  combine_sizes(_ncomp, e.size_of_components(), "components");
+  combine_sizes(size_of_panes(), e.size_of_panes(), "panes");
+
+  for (int k = 0, n = _panes.size(); k < n; ++k) {
+    const int length = bind(k);
+    const int elength = e.bind(k);
+    COM_assertion_msg(
+        elength < 0 || elength == length,
+        (std::string("Numbers of items do not match in expression for ") +
+         _attr->fullname() + " on pane " + std::to_string(_panes[k]->id()))
+            .c_str());
+    (void)elength;  // Unused if assertions are disabled
+
+    // Optimized version for contiguous dataitems
+    if (_contig && e.contiguous()) {
+      double *zval = _comps[0];
+      for (int i = 0, s = length * _ncomp; i < s; ++i) zval[i] = e[i];
+    } else {  // General version
+      for (int c = 0; c < _ncomp; ++c) {
+        double *zval = _comps[c];
+        const int zstrd = _strds[c];
+        for (int j = 0; j < length; ++j) zval[j * zstrd] = e(j, c);
+      }
+    }
+  }
+  return *this;
+}
+
+/** Sums up n expressions of the same shape in a single loop per pane.
+ *  The results are stored in s[0..n-1] and reduced with a single
+ *  MPI_Allreduce if comm is given.
+ */
+template <class E0, class E1>
+void sum(const Expr<E0> &expr0, const Expr<E1> &expr1, double *s,
+         const MPI_Comm *comm = NULL) {
+  const E0 &e0 = expr0.self();
+  const E1 &e1 = expr1.self();
+  COM_assertion_msg(
+      e0.size_of_components() > 0 && e1.size_of_components() > 0,
+      "Cannot reduce a scalar expression");
+  const int ncomp = combine_sizes(e0.size_of_components(),
+                                  e1.size_of_components(), "components");
+  const int npanes =
+      combine_sizes(e0.size_of_panes(), e1.size_of_panes(), "panes");
+
+  double s0 = 0, s1 = 0;
+  for (int k = 0; k < npanes; ++k) {
+    const int length = e0.bind(k), length1 = e1.bind(k);
+    COM_assertion_msg(length1 == length,
+                      "Numbers of items do not match in expression");
+    (void)length1;  // Unused if assertions are disabled
+
+    // Optimized version for contiguous dataitems
+    if (e0.contiguous() && e1.contiguous()) {
+      for (int i = 0, n = length * ncomp; i < n; ++i) {
+        s0 += e0[i];
+        s1 += e1[i];
+      }
+    } else {  // General version
+      for (int c = 0; c < ncomp; ++c)
+        for (int j = 0; j < length; ++j) {
+          s0 += e0(j, c);
+          s1 += e1(j, c);
+        }
+    }
+  }
+
+  s[0] = s0;
+  s[1] = s1;
+  if (comm && *comm != MPI_COMM_NULL && COMMPI_Initialized()) {
+    double t[2] = {s0, s1};
+    MPI_Allreduce(t, s, 2, MPI_DOUBLE, MPI_SUM, *comm);
+  }
+}
+
+/// Sums up the values of an expression over all the panes and processes.
+template <class E>
+double sum(const Expr<E> &expr, const MPI_Comm *comm = NULL) {
+  const E &e = expr.self();
+  const int ncomp = e.size_of_components();
+  const int npanes = e.size_of_panes();
+  COM_assertion_msg(ncomp > 0, "Cannot reduce a scalar expression");
+
+  double s = 0;
+  for (int k = 0; k < npanes; ++k) {
+    const int length = e.bind(k);
+
+    // Optimized version for contiguous dataitems
+    if (e.contiguous()) {
+      for (int i = 0, n = length * ncomp; i < n; ++i) s += e[i];
+    } else {  // General version
+      for (int c = 0; c < ncomp; ++c)
+        for (int j = 0; j < length; ++j) s += e(j, c);
+    }
+  }
+
+  if (comm && *comm != MPI_COMM_NULL && COMMPI_Initialized()) {
+    double t = s;
+    MPI_Allreduce(&t, &s, 1, MPI_DOUBLE, MPI_SUM, *comm);
+  }
+  return s;
+}
+
+/// Dot product of two expressions.
+template <class L, class R>
+double dot(const Expr<L> &l, const Expr<R> &r, const MPI_Comm *comm = NULL) {
+  return sum(l * r, comm);
+}
+
+/// Squared 2-norm of an expression.
+template <class E>
+double nrm2(const Expr<E> &e, const MPI_Comm *comm = NULL) {
+  return sum(sqr(e), comm);
+}
+
+/// Squared 2-norms of two expressions with a single MPI_Allreduce.
+template <class E0, class E1>
+void nrm2(const Expr<E0> &e0, const Expr<E1> &e1, double *s,
+          const MPI_Comm *comm = NULL) {
+  sum(sqr(e0), sqr(e1), s, comm);
+}
+
+}  // namespace Rocblas_expr
+
+#endif  // _ROCBLAS_EXPR_H_
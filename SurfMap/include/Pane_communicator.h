@@ -60,7 +60,9 @@ class Pane_communicator {
 
   /// Constructor from a communicator.
   /// Also initialize the internal data structures of the communicator,
-  /// in particular the internal pane IDs.
+  /// in particular the internal pane IDs. With a distributed pane directory,
+  /// it looks up the panes in the pconn of w, so it is collective over the
+  /// communicator of w.
   explicit Pane_communicator(COM::Window *w, MPI_Comm c = MPI_COMM_WORLD);
 
   // MS added
@@ -129,12 +131,21 @@ class Pane_communicator {
 
   ///  Initialize the communication buffers.
   ///  att is a pointer to the dataitem
-  ///  my_pconn stores pane-connectivity
+  ///  my_pconn stores pane-connectivity. If it is not the default pconn,
+  ///  this is collective as the constructor.
   void init(COM::DataItem *att, const COM::DataItem *my_pconn = NULL);
 
+  ///  Reset the data pointers from a dataitem with the same data type and
+  ///  number of components as in the last call to init, while keeping the
+  ///  communication buffers and MPI tags computed by init.
+  void reset_data(COM::DataItem *att);
+
   /// Obtain the MPI communicator for the object
   MPI_Comm mpi_comm() const { return _comm; }
 
+  /// Obtain the id of the pconn being used.
+  int pconn_id() const { return _my_pconn_id; }
+
   /// Obtains all the local panes.
   std::vector<COM::Pane *> &panes() { return _panes; }
 
@@ -151,7 +162,7 @@ class Pane_communicator {
   /// unique and contiguous across processes
   int lpaneid(const int pane_id) const {
     COM_assertion(_total_npanes > 0);
-    return _lpaneid_map.find(pane_id)->second;
+    return _appl_window->pane_index(pane_id);
   }
 
   /// Initiates updating shared nodes by calling MPI_Isend and MPI_Irecv.
@@ -194,6 +205,11 @@ class Pane_communicator {
     end_update();
   }
 
+  /// Abandons a pending update by cancelling its receive requests and
+  /// waiting for all its requests to complete, so that the buffers can be
+  /// freed.
+  void cancel_update();
+
   /// Perform a reduction operation using locally cached values of the shared
   /// nodes, assuming begin_update_shared_nodes() has been called.
   void reduce_on_shared_nodes(MPI_Op);
@@ -241,10 +257,6 @@ class Pane_communicator {
   std::vector<COM::Pane *> _panes;
   /// The total number of panes on all processes
   int _total_npanes;
-  /// Mapping from user-defined pane ids to internal IDs, which
-  /// are unique and contiguous across all processes, which are useful
-  /// for defining unique tags for MPI messages.
-  std::map<int, int> _lpaneid_map;
   /// The base data type, number of components, and the number of bytes of
   /// all components for the data to be communicated.
   int _type, _ncomp, _ncomp_bytes;
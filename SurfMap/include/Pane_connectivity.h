@@ -54,6 +54,12 @@ class Pane_connectivity {
   /// reading a pconn dataitem.
   static int pconn_offset() { return _pconn_offset; }
 
+  /// Look up the owners of the panes listed in the pconn of the local panes
+  /// if the window of pconn has a distributed pane directory, so that
+  /// owner_rank and pane_index can be called on them. Must be called
+  /// collectively by all processes of the owner window of pconn.
+  static void resolve_cpanes(COM::DataItem *pconn);
+
  protected:
   /** Create b2v mapping (pane connectivity) for nodes or edges and store
    *  the solution into the given Roccom DataItem.
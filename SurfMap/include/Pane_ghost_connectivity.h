@@ -52,6 +52,76 @@ using std::setw;
 using std::string;
 using std::vector;
 
+/// A node of the total ordering, with its owner pane P in the upper and its
+/// node id N on the owner pane in the lower 32 bits, so that keys sort by
+/// (P,N).
+typedef unsigned long long Node_key;
+
+inline Node_key node_key(int P, int N) {
+  return (Node_key(unsigned(P)) << 32) | unsigned(N);
+}
+
+/// A list of nodes in the total ordering with their local node ids. Lists
+/// are filled in any order and then sorted by key with duplicates removed.
+typedef vector<pair<Node_key, int> > Node_list;
+
+/// Maps nodes in the total ordering to local node ids. It is an
+/// open-addressing hash table with linear probing over a flat array;
+/// local node ids are positive, so a zero id marks an empty slot.
+class Node_table {
+ public:
+  Node_table() : _mask(0), _size(0) {}
+
+  /// Remove all nodes and make room for n nodes without rehashing.
+  void reset(std::size_t n) {
+    std::size_t capacity = 16;
+    while (capacity < 2 * n) capacity *= 2;
+    _slots.assign(capacity, pair<Node_key, int>(0, 0));
+    _mask = capacity - 1;
+    _size = 0;
+  }
+
+  /// Insert the node with the given local id unless it is already in the
+  /// table. Returns the local id the node is mapped to.
+  int insert(Node_key key, int lid) {
+    if (2 * (_size + 1) > _slots.size()) grow();
+    std::size_t i = home(key);
+    for (; _slots[i].second != 0; i = (i + 1) & _mask)
+      if (_slots[i].first == key) return _slots[i].second;
+    _slots[i] = make_pair(key, lid);
+    ++_size;
+    return lid;
+  }
+
+  /// Returns the local id of the node, or 0 if it is not in the table.
+  int find(Node_key key) const {
+    if (_slots.empty()) return 0;
+    std::size_t i = home(key);
+    for (; _slots[i].second != 0; i = (i + 1) & _mask)
+      if (_slots[i].first == key) return _slots[i].second;
+    return 0;
+  }
+
+  std::size_t size() const { return _size; }
+
+ private:
+  std::size_t home(Node_key key) const {
+    key *= 0x9E3779B97F4A7C15ULL;
+    return std::size_t(key ^ (key >> 32)) & _mask;
+  }
+
+  void grow() {
+    vector<pair<Node_key, int> > old;
+    old.swap(_slots);
+    reset(old.size());
+    for (std::size_t i = 0; i < old.size(); ++i)
+      if (old[i].second != 0) insert(old[i].first, old[i].second);
+  }
+
+  vector<pair<Node_key, int> > _slots;
+  std::size_t _mask, _size;
+};
+
 class Pane_ghost_connectivity {
  public:
   /// Constructors
@@ -81,7 +151,7 @@ class Pane_ghost_connectivity {
    */
   void get_ents_to_send(
       vector<vector<vector<int> > > &gelem_lists,
-      vector<vector<map<pair<int, int>, int> > > &nodes_to_send,
+      vector<vector<Node_list> > &nodes_to_send,
       vector<vector<deque<int> > > &elems_to_send,
       vector<vector<int> > &comm_sizes);
 
@@ -90,7 +160,7 @@ class Pane_ghost_connectivity {
   void process_received_data(
       vector<vector<vector<int> > > &recv_info,
       vector<vector<int> > &elem_renumbering,
-      vector<vector<map<pair<int, int>, int> > > &nodes_to_recv);
+      vector<vector<Node_list> > &nodes_to_recv);
 
   // Take the data we've collected and turn it into the pconn
   // Remember that there are 5 blocks in the pconn:
@@ -109,8 +179,8 @@ class Pane_ghost_connectivity {
   // new ghost elements. Do this while looking through recv_info
   // for GCR
 
-  void finalize_pconn(vector<vector<map<pair<int, int>, int> > > &nodes_to_send,
-                      vector<vector<map<pair<int, int>, int> > > &nodes_to_recv,
+  void finalize_pconn(vector<vector<Node_list> > &nodes_to_send,
+                      vector<vector<Node_list> > &nodes_to_recv,
                       vector<vector<deque<int> > > &elems_to_send,
                       vector<vector<int> > &elem_renumbering,
                       vector<vector<vector<int> > > &recv_info);
@@ -157,7 +227,7 @@ class Pane_ghost_connectivity {
   DataItem *_w_n_gorder;
 
   // mapping from total ordering to local node id
-  vector<map<pair<int, int>, int> > _local_nodes;
+  vector<Node_table> _local_nodes;
 
   // pointers to all local panes
   vector<Pane *> _panes;
@@ -10,11 +10,16 @@
 #ifndef __ROCMAP_H_
 #define __ROCMAP_H_
 
+#include <map>
+#include <mutex>
+#include <string>
 #include "com_devel.hpp"
 #include "mapbasic.h"
 
 MAP_BEGIN_NAMESPACE
 
+class Pane_communicator;
+
 class Rocmap {
  public:
   Rocmap() {}
@@ -56,6 +61,112 @@ class Rocmap {
   /// Update ghost nodal or elemental values for the given attribute.
   static void update_ghosts(COM::DataItem *att,
                             const COM::DataItem *pconn = NULL);
+
+  /** Begin a reduction on the shared nodes for the given attribute and
+   *  return a request handle in req. op is one of "sum", "min", "max",
+   *  "average", "maxabs" and "minabs". The values of the shared nodes have
+   *  been copied into the send buffers on return; they must not be
+   *  changed before end_reduce, which overwrites them with the result.
+   *  The attribute is therefore registered as both input and output. */
+  static void begin_reduce(COM::DataItem *att, const char *op, int *req,
+                           COM::DataItem *pconn = NULL);
+
+  /// Complete a reduction started by begin_reduce.
+  static void end_reduce(const int *req);
+
+  /** Begin updating the ghost nodal or elemental values for the given
+   *  attribute and return a request handle in req. The ghost values must
+   *  not be used before end_update_ghosts, which overwrites them. The
+   *  attribute is therefore registered as both input and output. */
+  static void begin_update_ghosts(COM::DataItem *att, int *req,
+                                  const COM::DataItem *pconn = NULL);
+
+  /// Complete a ghost update started by begin_update_ghosts.
+  static void end_update_ghosts(const int *req);
+
+  /** Set flags, an integer attribute on the window of a pending request,
+   *  to 1 for the items that will be overwritten when the request
+   *  completes (the shared nodes of a reduction or the ghost items of a
+   *  ghost update) and to 0 for all others. Computations restricted to the
+   *  items flagged 0 can run while the messages are in flight. flags must
+   *  be nodal, or elemental for a ghost update of an elemental attribute. */
+  static void mark_pending_items(const int *req, COM::DataItem *flags);
+
+ protected:
+  /// Key of a communication plan: the window, the id of the pconn, the
+  /// data type and the number of components.
+  struct Comm_plan_key {
+    const COM::Window *win;
+    int pconn_id, type, ncomp;
+
+    bool operator<(const Comm_plan_key &k) const {
+      if (win != k.win) return win < k.win;
+      if (pconn_id != k.pconn_id) return pconn_id < k.pconn_id;
+      if (type != k.type) return type < k.type;
+      return ncomp < k.ncomp;
+    }
+  };
+
+  /// A cached Pane_communicator along with the name and initialization
+  /// stamp of its window at the time it was built, and whether it is in
+  /// use by a pending request.
+  struct Comm_plan {
+    std::string wname;
+    long stamp;
+    Pane_communicator *pc;
+    bool busy;
+  };
+  typedef std::map<Comm_plan_key, Comm_plan> Comm_plans;
+
+  /// The operations of a pending request.
+  enum Request_op {
+    REDUCE_SUM,
+    REDUCE_MIN,
+    REDUCE_MAX,
+    REDUCE_AVERAGE,
+    REDUCE_MAXABS,
+    REDUCE_MINABS,
+    UPDATE_GHOST_NODES,
+    UPDATE_GHOST_CELLS
+  };
+
+  /// A pending split-phase reduction or ghost update.
+  struct Request {
+    Pane_communicator *pc;
+    Request_op op;
+  };
+  typedef std::map<int, Request> Requests;
+
+  /** Obtain a Pane_communicator for the given dataitem and pconn. The
+   *  communication buffers and tags are computed on the first call and
+   *  reused until the window is reinitialized by COM_window_init_done.
+   *  If the cached plan is in use by a pending request, a new one is
+   *  built. Each plan must be released with release_comm_plan. */
+  static Pane_communicator *get_comm_plan(COM::DataItem *att,
+                                          const COM::DataItem *pconn);
+
+  /// Release a plan obtained from get_comm_plan.
+  static void release_comm_plan(Pane_communicator *pc);
+
+  /** Delete the cached plans that are not in use and whose window has
+   *  been deleted or reinitialized since they were built. The caller
+   *  must hold _mutex. */
+  static void evict_stale_comm_plans();
+
+  /// Cancel all pending requests and delete all cached communication plans.
+  static void clear_comm_plans();
+
+  /// Start a request and return its handle.
+  static int begin_request(COM::DataItem *att, const COM::DataItem *pconn,
+                           Request_op op);
+
+  /// Remove the request with the given handle and return it.
+  static Request take_request(int req);
+
+  static Comm_plans _comm_plans;
+  static Requests _requests;
+  static int _last_request;  ///< Handle of the last request
+  static std::mutex _mutex;  ///< Guards the plans and the requests
 };
 
 MAP_END_NAMESPACE
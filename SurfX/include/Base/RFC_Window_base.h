@@ -364,6 +364,10 @@ class RFC_Pane_base {
 
   int get_lvid(const Element_node_enumerator &ene, const int v) const;
 
+  //! Write the subnodes and subfaces in native binary format, as in
+  //! write_binary but without the mesh and the pane connectivity.
+  void write_subdivision(std::ostream &os) const;
+
  protected:
   //! Compute the natural coordinates.
   void comp_nat_coors();
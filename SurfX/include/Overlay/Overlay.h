@@ -49,6 +49,11 @@ class Overlay {  // Updated: Feb. 25, 2001
   // Set tolerance for snapping vertices.
   void set_tolerance(double tol);
 
+  // Allow the blue window to cover only part of the green window, as
+  // when each process overlays its own blue panes against the green
+  // panes overlapping them. The bounding boxes are then not compared.
+  void set_partial(bool partial) { is_partial = partial; }
+
   // Interfaces for the data transfer algorithms
   RFC_Window_overlay *get_rfc_window(const COM::Window *w) {
     return (B->base() == w) ? B : G;
@@ -223,6 +228,7 @@ class Overlay {  // Updated: Feb. 25, 2001
   HDS_accessor acc;
 
   bool is_opposite;
+  bool is_partial;
   bool verbose;
   bool verbose2;
   std::string out_pre;  // Output prefix
@@ -22,6 +22,7 @@ extern "C" void SurfX_unload_module(const char *);
 #ifdef __cplusplus
 
 #include <map>
+#include <vector>
 #include "com_devel.hpp"
 #include "rfc_basic.h"
 
@@ -35,10 +36,18 @@ class Rocface : public COM_Object {
   typedef std::map<std::string, RFC_Window_transfer *> TRS_Windows;
 
   struct Control_parameters {
-    Control_parameters() : verb(0), snap(1.e-3) {}
+    Control_parameters()
+        : verb(0),
+          snap(1.e-3),
+          pipelined_cg(0),
+          cache_mass_matrix(0),
+          cache_operators(0) {}
 
     int verb;
     double snap;
+    int pipelined_cg;  // Use pipelined CG for conservative transfer to nodes
+    int cache_mass_matrix;  // Keep assembled mass matrices across transfers
+    int cache_operators;    // Keep interpolations and quadratures likewise
   };
 
  public:
@@ -51,6 +60,22 @@ class Rocface : public COM_Object {
   // set verbose level
   void set_verbose(int *verbose);
 
+  // select pipelined (nonzero) or standard (0) conjugate gradient solver
+  // for least-squares transfers to nodes
+  void set_pipelined_cg(int *pipelined);
+
+  // keep (nonzero) or discard (0) the mass matrices assembled for
+  // least-squares transfers to nodes across calls
+  void set_cache_mass_matrix(int *cache);
+
+  // keep (nonzero) or discard (0) the interpolation weights and subface
+  // quadratures recorded by transfers across calls
+  void set_cache_operators(int *cache);
+
+  // notify that the nodal coordinates of the given window have changed,
+  // so that the operators cached for its overlays must be recomputed
+  void mesh_changed(const char *wname);
+
   // read Rocface control file
   void read_control_file(const char *fname);
 
@@ -71,6 +96,13 @@ class Rocface : public COM_Object {
                     const MPI_Comm *comm, const char *prefix1 = NULL,
                     const char *prefix2 = NULL, const char *format = NULL);
 
+  // Construct the overlay of two distributed meshes without gathering
+  // them, as a replacement for overlay, write_overlay and read_overlay.
+  // Each process overlays its own panes of mesh1 against the panes of
+  // mesh2 whose bounding boxes overlap them.
+  void parallel_overlay(const COM::DataItem *mesh1, const COM::DataItem *mesh2,
+                        const MPI_Comm *comm = NULL);
+
   void set_tags(const COM::DataItem *src, const COM::DataItem *trg,
                 const COM::DataItem *tags);
 
@@ -84,6 +116,19 @@ class Rocface : public COM_Object {
                               const Real *alp = NULL, const int *ord = NULL,
                               Real *tol = NULL, int *iter = NULL);
 
+  /// Transfer several fields between the same pair of windows in one call,
+  /// with a single integration over the overlay and a block solver.
+  /// \param srcs Handles of the source dataitems. They may be nodal or
+  ///             facial.
+  /// \param trgs Handles of the corresponding nodal target dataitems.
+  /// \param nfields Number of dataitems in srcs and trgs.
+  /// \param tol On return, the largest relative error of the fields.
+  /// Other parameters are the same as for least_squares_transfer.
+  void least_squares_transfer_fields(const int *srcs, const int *trgs,
+                                     const int *nfields, const Real *alp = NULL,
+                                     const int *ord = NULL, Real *tol = NULL,
+                                     int *iter = NULL);
+
   void interpolate(const COM::DataItem *att1, COM::DataItem *att2);
 
   void load_transfer(const COM::DataItem *att1, COM::DataItem *att2,
@@ -117,6 +162,18 @@ class Rocface : public COM_Object {
                 const int order = 2, Real *tol = NULL, int *iter = NULL,
                 bool load = false);
 
+  /// Transfer the fields srcs to the nodal fields trgs together.
+  /// \see transfer
+  template <class Source_type, class Transfer_type>
+  void transfer_fields(const std::vector<const COM::DataItem *> &srcs,
+                       const std::vector<COM::DataItem *> &trgs,
+                       const Real alpha, const int order, Real *tol,
+                       int *iter);
+
+  /// Get the windows of the overlay of the windows of src and trg.
+  void get_overlay_windows(const COM::DataItem *src, const COM::DataItem *trg,
+                           RFC_Window_transfer *&w1, RFC_Window_transfer *&w2);
+
   int validate_object() const {
     if (_cookie != RFC_COOKIE)
       return -1;
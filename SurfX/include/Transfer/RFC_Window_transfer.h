@@ -32,6 +32,34 @@ typedef RFC_Data_const<Tag_facial> Facial_data_const;
 typedef RFC_Data<Tag_nodal> Nodal_data;
 typedef RFC_Data<Tag_facial> Facial_data;
 
+// A linear operator recorded by Transfer_base on a target pane, which
+// replaces the evaluation of shape functions and quadrature rules on a
+// fixed overlay. Row i evaluates a source field as the combination of its
+// values at the items (nodes or faces) items[k] of the source pane
+// panes[i] with the weights weights[k], for offsets[i] <= k < offsets[i+1],
+// and contributes the result to the item targets[i] of the target pane.
+// For the loads, the rows are quadrature points of the subfaces, the
+// targets are faces, areas holds the Jacobian weights of the points in
+// the target mesh, and shapes holds the values of the shape functions of
+// the target face at each point one row after another.
+struct Transfer_operator {
+  // Kinds of operators, each recorded separately for nodal sources at
+  // kind+1 and for facial sources at kind.
+  enum Kind { INTERPOLATION = 0, NODAL_LOADS = 2, FACIAL_LOADS = 4,
+              NUM_KINDS = 6 };
+
+  std::vector<int> offsets;
+  std::vector<int> panes;
+  std::vector<int> targets;
+  std::vector<int> items;
+  std::vector<Real> weights;
+  std::vector<Real> areas;
+  std::vector<Real> shapes;
+
+  int size() const { return int(panes.size()); }
+  void clear();
+};
+
 // RFC_Pane_transfer is built based on RFC_Pane_base with extension of
 //    extra dataitem for storing buffers for data transfer.
 class RFC_Pane_transfer : public RFC_Pane_base {
@@ -47,14 +75,14 @@ class RFC_Pane_transfer : public RFC_Pane_base {
   const RFC_Window_transfer *window() const { return _window; }
 
   Real *pointer(int i) {
-    if (i >= 0) {
-      if (is_master())
-        return Base::pointer(i);
-      else {
-        RFC_assertion(_data_buf_id == i);
-        return &_data_buf.front();
-      }
-    } else
+    // A replicated pane holds only the data (a dataitem or a buffer of
+    // the owner) last replicated by RFC_Window_transfer::replicate_data.
+    if (!is_master()) {
+      RFC_assertion(_data_buf_id == i);
+      return &_data_buf.front();
+    } else if (i >= 0)
+      return Base::pointer(i);
+    else
       return &_buffer[-i - 1][0];
   }
   const Real *pointer(int i) const {
@@ -85,6 +113,26 @@ class RFC_Pane_transfer : public RFC_Pane_base {
 
   bool is_master() const { return _base->window() != NULL; }
 
+  // Check whether the faces are restricted by tags set by set_tags.
+  bool is_tagged() const { return _to_recv != NULL; }
+
+  // Check whether the mass matrix has been assembled by
+  // RFC_Window_transfer::assemble_mass_matrix.
+  bool has_mass_matrix() const { return !_mm_rows.empty(); }
+
+  // Multiply the assembled mass matrix with the nodal vector x with d
+  // components per node, and store the local part of the product into y.
+  void multiply_mass_matrix(const Real *x, Real *y, int d) const;
+
+  // Get the transfer operator of the given kind recorded on this pane.
+  Transfer_operator &transfer_operator(int kind) {
+    RFC_assertion(kind >= 0 && kind < Transfer_operator::NUM_KINDS);
+    return _ops[kind];
+  }
+  const Transfer_operator &transfer_operator(int kind) const {
+    return const_cast<Self *>(this)->transfer_operator(kind);
+  }
+
  private:
   // Data member
   RFC_Window_transfer *_window;  // Point to its parent window.
@@ -93,6 +141,17 @@ class RFC_Pane_transfer : public RFC_Pane_base {
   std::vector<int> _emm_offset;             // Element mass matrix
   std::vector<Real> _emm_buffer;
 
+  // Mass matrix assembled from the element mass matrices in compressed
+  // sparse row format with zero-based node indices, and its diagonal
+  // summed over the panes sharing each node.
+  std::vector<int> _mm_rows;
+  std::vector<int> _mm_cols;
+  std::vector<Real> _mm_vals;
+  std::vector<Real> _mm_diag;
+
+  // Transfer operators recorded for the overlay.
+  Transfer_operator _ops[Transfer_operator::NUM_KINDS];
+
   int _data_buf_id;
   std::vector<Real> _coor_buf;
   std::vector<Real> _data_buf;
@@ -135,6 +194,34 @@ class RFC_Window_transfer : public RFC_Window_derived<RFC_Pane_transfer> {
   Nodal_data nodal_buffer(int);
   void delete_nodal_buffers();
 
+  /// Assemble the element mass matrices of the local panes, computed
+  /// into the buffers allocated by init_nodal_buffers, into sparse
+  /// matrices that are kept across transfers, together with the first
+  /// component of diag. key identifies the quadrature used.
+  void assemble_mass_matrix(int key, const Nodal_data_const &diag);
+  /// Get the key of the assembled mass matrix, or -1 if there is none.
+  int mass_matrix_key() const { return _mm_key; }
+  /// Copy the saved diagonal of the mass matrix into diag.
+  void get_mass_matrix_diagonal(Nodal_data &diag) const;
+  /// Discard the assembled mass matrix.
+  void clear_mass_matrix();
+
+  /// Check whether the transfer operators of the given kind have been
+  /// recorded on the local panes for the quadrature key and coordinate
+  /// interpolation parameter alpha.
+  bool has_transfer_operator(int kind, int key, Real alpha) const {
+    RFC_assertion(kind >= 0 && kind < Transfer_operator::NUM_KINDS);
+    return _op_keys[kind] == key && _op_alphas[kind] == alpha;
+  }
+  /// Mark the transfer operators of the given kind as recorded.
+  void set_transfer_operator_key(int kind, int key, Real alpha) {
+    RFC_assertion(kind >= 0 && kind < Transfer_operator::NUM_KINDS);
+    _op_keys[kind] = key;
+    _op_alphas[kind] = alpha;
+  }
+  /// Discard the recorded transfer operators.
+  void clear_transfer_operators();
+
   // Set _to_recv tags for the next data transfer algorithm.
   // If tag is NULL, reset the tags to NULL.
   void set_tags(const COM::DataItem *tag);
@@ -157,6 +244,40 @@ class RFC_Window_transfer : public RFC_Window_derived<RFC_Pane_transfer> {
   /// in opp_win.
   void replicate_metadata(const RFC_Window_transfer &opp_win);
 
+  /// Determine the panes of this window whose bounding boxes overlap
+  /// those of the panes of opp_win enlarged by eps times their diagonals.
+  /// overlaps maps each local pane of opp_win to the panes overlapping
+  /// it, and ids[p] lists the local panes overlapping a pane of opp_win
+  /// on process p.
+  void overlapping_panes(const RFC_Window_transfer &opp_win, Real eps,
+                         std::map<int, std::vector<int> > &overlaps,
+                         std::vector<std::vector<int> > &ids) const;
+
+  /// Send the meshes of the local panes in ids[p] to each process p, and
+  /// receive the meshes requested by this process into meshes.
+  void replicate_meshes(const std::vector<std::vector<int> > &ids,
+                        std::map<int, std::string> &meshes);
+
+  /// Register the given panes of the meshes received by replicate_meshes
+  /// into a new window wname on MPI_COMM_SELF.
+  static void register_meshes(const std::string &wname,
+                              const std::map<int, std::string> &meshes,
+                              const std::vector<int> &pane_ids);
+
+  /// Append the subdivisions of the panes of part, the window of this
+  /// color in the partial overlay with index k computed by this process,
+  /// to sbufs[p] for each owner p of the panes.
+  void pack_partial_sdv(const RFC_Window_base &part, int k,
+                        std::vector<std::string> &sbufs) const;
+
+  /// Merge the partial subdivisions packed by all the processes into the
+  /// local panes, and renumber accordingly the counterparts of the
+  /// subnodes and subfaces of the local panes of opp_win, where
+  /// opp_panes[k] is the pane of opp_win in the partial overlay k.
+  void merge_sdv(const std::vector<std::string> &sbufs,
+                 const std::vector<int> &opp_panes,
+                 RFC_Window_transfer &opp_win);
+
   /// Replicate the given data from remote processes onto local process.
   /// Replicate coordinates only if replicate_coor is true.
   void replicate_data(const Facial_data_const &data, bool replicate_coor);
@@ -187,6 +308,13 @@ class RFC_Window_transfer : public RFC_Window_derived<RFC_Pane_transfer> {
   }
   void allreduce(Real *x, MPI_Op op) const { allreduce(x, 1, op); }
 
+  /// Start an in-place reduction of n values over the processes of the
+  /// window. Returns true if the reduction is still pending and must be
+  /// completed by wait_all on req, or false if it has completed already
+  /// (with a single process or an MPI library without nonblocking
+  /// collectives).
+  bool begin_allreduce(Real *x, int n, MPI_Op op, MPI_Request *req) const;
+
  private:
   void allreduce(Real *, int n, MPI_Op op) const;
 
@@ -203,12 +331,38 @@ class RFC_Window_transfer : public RFC_Window_derived<RFC_Pane_transfer> {
   void init_send_buffer(int pane_id, int to_rank);
   void init_recv_buffer(int pane_id, int from_rank);
 
+  // Serialization of pane subdivisions for exchange_sdv.
+  static void pack_sdv(const RFC_Pane_transfer &p, std::ostream &os);
+  void unpack_sdv(const std::string &buf);
+  void exchange_sdv(const std::vector<int> &npanes_send,
+                    const std::vector<int> &ids_send);
+
+  // Serialization of pane meshes for replicate_meshes.
+  static void pack_mesh(const RFC_Pane_transfer &p, std::ostream &os);
+
+  // Gather the IDs and the bounding boxes of the panes of all processes.
+  void gather_bounding_boxes(std::vector<int> &ids, std::vector<int> &owners,
+                             std::vector<Bbox_3> &boxes) const;
+
+  // Merge the partial subdivisions of a local pane for merge_sdv.
+  struct Partial_sdv;
+  void merge_subdivisions(RFC_Pane_transfer &pn,
+                          std::vector<Partial_sdv *> &parts);
+
+  // Send sbufs[p] to each process p and receive rbufs[p] from it.
+  void exchange_buffers(const std::vector<std::string> &sbufs,
+                        std::vector<std::string> &rbufs, int tag);
+
  private:
   int _buf_dim;
+  int _mm_key;  // Key of the assembled mass matrix
+  int _op_keys[Transfer_operator::NUM_KINDS];  // Keys of transfer operators
+  Real _op_alphas[Transfer_operator::NUM_KINDS];
   MPI_Comm _comm;
   std::map<int, std::pair<int, int> > _pane_map;
   std::vector<int> _num_panes;
   std::map<int, RFC_Pane_transfer *> _replic_panes;
+  std::map<int, std::string> _replic_sdv;  // Serialized remote subdivisions
   bool _replicated;
 
   std::set<std::pair<int, RFC_Pane_transfer *> > _panes_to_send;  //<to_rank, p>
@@ -15,6 +15,7 @@
 #ifndef __TRANSFER_BASE_H_
 #define __TRANSFER_BASE_H_
 
+#include <algorithm>
 #include <cmath>
 #include "RFC_Window_transfer.h"
 #include "Timing.h"
@@ -39,7 +40,15 @@ class Transfer_base {
       Pane_const_iterator;
 
   Transfer_base(RFC_Window_transfer *s, RFC_Window_transfer *t)
-      : src(*s), trg(*t), sc(s->color()), _src_pane(NULL), _trg_pane(NULL) {
+      : src(*s),
+        trg(*t),
+        sc(s->color()),
+        _pipelined_cg(false),
+        _cache_mass_matrix(false),
+        _use_mass_matrix(false),
+        _cache_operators(false),
+        _src_pane(NULL),
+        _trg_pane(NULL) {
     src.panes(src_ps);
     trg.panes(trg_ps);
   }
@@ -71,6 +80,22 @@ class Transfer_base {
   void transfer_2n(const _SDF &sDF, Nodal_data &tDF, const Real alpha,
                    Real *tol, int *iter, int doa, bool verb);
 
+  /** template function for transfering several fields between the same
+   *  windows from nodes/faces to nodes. The load vectors of all the fields
+   *  are integrated in one pass over the subfaces, and the systems, which
+   *  share the mass matrix, are solved together by pcg_block.
+   *  \param sDFs  Souce data, all of the same window
+   *  \param tDFs  Target data, all of the same window, with the same
+   *               dimensions as the corresponding source data
+   *  \param tol   Tolerance of iterative solver. On return, the largest
+   *               relative error of the fields
+   *  \param iter  Number of iterations of iterative solver.
+   *  \see transfer_2n
+   */
+  template <class _SDF>
+  void transfer_2n(const std::vector<_SDF> &sDFs, std::vector<Nodal_data> &tDFs,
+                   const Real alpha, Real *tol, int *iter, int doa, bool verb);
+
   /** Perform finite-element interpolation (non-conservative), assuming
    *  source data has been replicated.
    *  \param sDF   Souce data
@@ -87,6 +112,25 @@ class Transfer_base {
   void loadtransfer(const _SDF &vS, Nodal_data &vT, const Real alpha,
                     const int order, bool verb);
 
+  /** Select the linear solver for transfers to nodes.
+   *  \param b If true, use pcg_pipelined instead of pcg, and
+   *           pcg_block_pipelined instead of pcg_block.
+   */
+  void set_pipelined_cg(bool b) { _pipelined_cg = b; }
+
+  /** Select whether transfers to nodes keep the mass matrix of the target
+   *  window assembled across calls, until it is cleared.
+   *  \see RFC_Window_transfer::clear_mass_matrix
+   */
+  void set_cache_mass_matrix(bool b) { _cache_mass_matrix = b; }
+
+  /** Select whether transfers record the interpolation weights and the
+   *  quadratures of the subfaces of the overlay on first use, and reuse
+   *  them until they are cleared.
+   *  \see Transfer_operator, RFC_Window_transfer::clear_transfer_operators
+   */
+  void set_cache_operators(bool b) { _cache_operators = b; }
+
  protected:
   // Integrating over a sub-face whose parent element in the source
   // window is the face incident on s.
@@ -120,6 +164,59 @@ class Transfer_base {
           Nodal_data &r, Nodal_data &s, Nodal_data &z, Nodal_data &di,
           Real *tol, int *max_iter);
 
+  // Pipelined variant of pcg (Ghysels and Vanroose), which merges the
+  // dot products of each iteration into a single nonblocking reduction
+  // that overlaps with the matrix-vector product, and updates all the
+  // vectors in one sweep over the nodes. The residual overwrites b.
+  int pcg_pipelined(Nodal_data &x, Nodal_data &b, Nodal_data &z,
+                    Nodal_data &q, Nodal_data &s, Nodal_data &p, Nodal_data &u,
+                    Nodal_data &w, Nodal_data &m, Nodal_data &n,
+                    Nodal_data &di, Real *tol, int *max_iter);
+
+  // Block variant of pcg for several fields, where field k occupies the
+  // components offs[k] to offs[k+1]-1 of each node. Every field has its own
+  // step lengths and stops when it has converged, but the fields share the
+  // matrix-vector products and the reductions of each iteration.
+  int pcg_block(Nodal_data &x, Nodal_data &b, Nodal_data &p, Nodal_data &q,
+                Nodal_data &r, Nodal_data &s, Nodal_data &z, Nodal_data &di,
+                const std::vector<int> &offs, Real *tol, int *max_iter);
+
+  // Pipelined variant of pcg_block, as pcg_pipelined is of pcg. The
+  // residuals overwrite b.
+  int pcg_block_pipelined(Nodal_data &x, Nodal_data &b, Nodal_data &z,
+                          Nodal_data &q, Nodal_data &s, Nodal_data &p,
+                          Nodal_data &u, Nodal_data &w, Nodal_data &m,
+                          Nodal_data &n, Nodal_data &di,
+                          const std::vector<int> &offs, Real *tol,
+                          int *max_iter);
+
+  /** Check whether the transfer operators are cached, and if so, record
+   *  the operators of the given kind on the local target panes unless
+   *  they have been recorded already for doa and alpha.
+   *  \param kind  Kind of operator, offset by 1 for nodal sources
+   */
+  bool cache_operator(int kind, const Real alpha, int doa);
+
+  // Record the transfer operators of a target pane.
+  void record_interpolation(RFC_Pane_transfer *p_trg, bool nodal,
+                            Transfer_operator &op);
+  void record_nodal_loads(RFC_Pane_transfer *p_trg, bool nodal,
+                          const Real alpha, int doa, Transfer_operator &op);
+  void record_facial_loads(RFC_Pane_transfer *p_trg, bool nodal,
+                           const Real alpha, int doa, Transfer_operator &op);
+
+  // Apply the transfer operators of a target pane to the source data sid,
+  // as done by interpolate_fe, compute_load_vector_wra and integrate_subface
+  // respectively.
+  void apply_interpolation(const Transfer_operator &op, int sid,
+                           RFC_Pane_transfer *p_trg, Nodal_data &tDF);
+  void apply_nodal_loads(const Transfer_operator &op, int sid,
+                         RFC_Pane_transfer *p_trg, Nodal_data &rhs,
+                         Nodal_data &diag, bool lump);
+  void apply_facial_loads(const Transfer_operator &op, int sid,
+                          RFC_Pane_transfer *p_trg, Facial_data &tDF,
+                          Facial_data &tBF);
+
   /// Diagonal (Jacobi) preconditioner
   /// \param rhs is the right-hand side of the system
   /// \param diag is the diagonal of the mass matrix.
@@ -139,6 +236,11 @@ class Transfer_base {
             const Nodal_data_const &x2, const Nodal_data_const &y2,
             Array_n prod) const;
 
+  // Compute the local parts of the products of the fields of x and y,
+  // as laid out for pcg_block, without reducing them over the processes.
+  void dot_fields(const Nodal_data_const &x, const Nodal_data_const &y,
+                  const std::vector<int> &offs, Real *prods) const;
+
   void scale(const Real &a, Nodal_data &x);
   void invert(Nodal_data &x);
 
@@ -245,6 +347,10 @@ class Transfer_base {
   RFC_Window_transfer &src;
   RFC_Window_transfer &trg;
   int sc;
+  bool _pipelined_cg;       // Whether to use the pipelined solvers in transfer_2n
+  bool _cache_mass_matrix;  // Whether to assemble and keep the mass matrix
+  bool _use_mass_matrix;    // Whether the assembled mass matrix is in use
+  bool _cache_operators;    // Whether to record and reuse Transfer_operator
 
  private:
   // Caches for the pane
@@ -263,6 +369,47 @@ class Transfer_base {
     return _trg_pane;
   }
 
+  // Evaluate row i of op for the source data sid with d components into v.
+  // p_src and s cache the source pane of the previous row and its data.
+  void evaluate_row(const Transfer_operator &op, int i, int sid, int d,
+                    const RFC_Pane_transfer *&p_src, const Real *&s,
+                    Real *v) const {
+    if (!p_src || p_src->id() != op.panes[i]) {
+      p_src = &src.pane(op.panes[i]);
+      s = p_src->pointer(sid);
+    }
+    std::fill(v, v + d, Real(0));
+    for (int k = op.offsets[i]; k < op.offsets[i + 1]; ++k) {
+      const Real w = op.weights[k], *sk = s + (op.items[k] - 1) * d;
+      for (int c = 0; c < d; ++c) v[c] += w * sk[c];
+    }
+  }
+
+  /** Copy the fields sDFs, with d components in total, one after another
+   *  into a buffer of the local panes of the source window, and return
+   *  the buffer. It is released by delete_source_buffer.
+   */
+  template <class _SDF>
+  _SDF pack_source_data(const std::vector<_SDF> &sDFs, int d);
+
+  Nodal_data_const init_source_buffer(Tag_nodal, int d) {
+    src.init_nodal_buffers(Nodal_data(0, d), 1, false);
+    return src.nodal_buffer(0);
+  }
+  Facial_data_const init_source_buffer(Tag_facial, int d) {
+    src.init_facial_buffers(Facial_data(0, d), 1);
+    return src.facial_buffer(0);
+  }
+  void delete_source_buffer(Tag_nodal) { src.delete_nodal_buffers(); }
+  void delete_source_buffer(Tag_facial) { src.delete_facial_buffers(); }
+
+  int size_of_items(const RFC_Pane_transfer *p, Tag_nodal) const {
+    return p->size_of_nodes();
+  }
+  int size_of_items(const RFC_Pane_transfer *p, Tag_facial) const {
+    return p->size_of_faces();
+  }
+
   /** Construct a element-wise accessor from nodal data and pointers */
   Element_var_const make_field(const Nodal_data_const &d,
                                const RFC_Pane_transfer *pn, const ENE &ene) {